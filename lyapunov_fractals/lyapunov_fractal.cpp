@@ -2,8 +2,8 @@
 #include <cmath>
 
 
-// Computes the Lyapunov exponent
-float computeLyapunov(const std::string& sequence, float a, float b) {
+// Computes the Lyapunov exponent over an A/B/C sequence
+float computeLyapunov3(const std::string& sequence, float a, float b, float c) {
     size_t seqLength = sequence.size();
     if (seqLength == 0) return -1.0f; // Invalid sequence
 
@@ -11,7 +11,8 @@ float computeLyapunov(const std::string& sequence, float a, float b) {
     float lyapunovExponent = 0.0f;
 
     for (int i = 0; i < 6000; ++i) { // MAX_ITERATIONS is set to 6000
-        float r = (sequence[i % seqLength] == 'A') ? a : b;
+        char s = sequence[i % seqLength];
+        float r = (s == 'A') ? a : (s == 'B') ? b : c;
 
         x = r * x * (1.0f - x);
         if (x <= 0.0f || x >= 1.0f) return -1.0f;
@@ -25,6 +26,11 @@ float computeLyapunov(const std::string& sequence, float a, float b) {
     return lyapunovExponent / 6000; // MAX_ITERATIONS
 }
 
+// Computes the Lyapunov exponent, an A/B sequence is the A/B/C case with c == b
+float computeLyapunov(const std::string& sequence, float a, float b) {
+    return computeLyapunov3(sequence, a, b, b);
+}
+
 // Maps a Lyapunov exponent value to a color (RGBA) //HELPED BY CHATGPT TO WRITE THIS FUNCTION
 uint32_t mapLyapunovToColor(float lyapunov) {
     if (lyapunov < 0) {
@@ -7,6 +7,10 @@
 // Computes the Lyapunov exponent for a given sequence, and parameters (a, b)
 float computeLyapunov(const std::string& sequence, float a, float b);
 
+// Computes the Lyapunov exponent for a three-letter sequence, and parameters (a, b, c)
+// 'A' selects a, 'B' selects b, 'C' selects c
+float computeLyapunov3(const std::string& sequence, float a, float b, float c);
+
 // Maps a Lyapunov exponent value to a color (RGBA format)
 uint32_t mapLyapunovToColor(float lyapunov);
 
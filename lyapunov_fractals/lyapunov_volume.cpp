@@ -0,0 +1,510 @@
+#include "lyapunov_volume.h"
+#include "lyapunov_fractal.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <omp.h>
+#include <zlib.h>
+
+namespace fs = std::filesystem;
+
+static const char CHUNK_MAGIC[4] = {'L', 'Y', 'C', '1'};
+static const uint8_t ENCODING_RAW = 0;
+static const uint8_t ENCODING_RLE = 1;
+static const uint8_t ENCODING_DELTA = 2;
+
+// Fixed size header in front of every chunk payload
+struct ChunkHeader {
+    char magic[4];
+    uint8_t encoding;
+    uint8_t reserved[3];
+    uint32_t voxelCount;
+    uint32_t payloadBytes;
+};
+
+static std::string metaPath(const std::string& storeDir) {
+    return (fs::path(storeDir) / "volume.meta").string();
+}
+
+static std::string chunkPath(const std::string& storeDir, int cx, int cy, int cz) {
+    return (fs::path(storeDir) / ("chunk_" + std::to_string(cx) + "_" + std::to_string(cy) + "_" +
+                                  std::to_string(cz) + ".bin")).string();
+}
+
+static int64_t chunkCount(int samples, int chunkSize) {
+    return (samples + chunkSize - 1) / chunkSize;
+}
+
+// Extent of a chunk along one axis, clipped at the volume border
+static int chunkExtent(int samples, int chunkSize, int index) {
+    return std::min(chunkSize, samples - index * chunkSize);
+}
+
+static std::string serializeConfig(const VolumeConfig& config) {
+    std::ostringstream out;
+    out << std::setprecision(9);
+    out << "sequence " << config.sequence << "\n";
+    out << "size " << config.width << " " << config.height << " " << config.depth << "\n";
+    out << "chunk " << config.chunkSize << "\n";
+    out << "a " << config.aMin << " " << config.aMax << "\n";
+    out << "b " << config.bMin << " " << config.bMax << "\n";
+    out << "c " << config.cMin << " " << config.cMax << "\n";
+    out << "exponent " << config.expMin << " " << config.expMax << "\n";
+    return out.str();
+}
+
+static bool validRange(float lo, float hi) {
+    return std::isfinite(lo) && std::isfinite(hi) && hi > lo;
+}
+
+bool validateVolumeConfig(const VolumeConfig& config) {
+    if (config.sequence.empty() || config.sequence.find_first_not_of("ABC") != std::string::npos) {
+        std::cerr << "Error: The sequence must be non-empty and contain only 'A', 'B' and 'C'.\n";
+        return false;
+    }
+    if (config.width <= 0 || config.height <= 0 || config.depth <= 0) {
+        std::cerr << "Error: Volume size must be positive.\n";
+        return false;
+    }
+    if (config.chunkSize < MIN_CHUNK_SIZE || config.chunkSize > MAX_CHUNK_SIZE) {
+        std::cerr << "Error: Chunk size must be in [" << MIN_CHUNK_SIZE << ", " << MAX_CHUNK_SIZE << "].\n";
+        return false;
+    }
+    if (!validRange(config.aMin, config.aMax) || !validRange(config.bMin, config.bMax) ||
+        !validRange(config.cMin, config.cMax)) {
+        std::cerr << "Error: Parameter ranges must be finite with min < max.\n";
+        return false;
+    }
+    if (!validRange(config.expMin, config.expMax)) {
+        std::cerr << "Error: Exponent range must be finite with min < max.\n";
+        return false;
+    }
+    return true;
+}
+
+bool loadVolumeConfig(const std::string& storeDir, VolumeConfig* config) {
+    std::ifstream in(metaPath(storeDir));
+    if (!in) {
+        std::cerr << "Error: No volume found in " << storeDir << "\n";
+        return false;
+    }
+
+    // Every key must be present, a truncated file must not fall back to defaults
+    const std::string keys[] = {"sequence", "size", "chunk", "a", "b", "c", "exponent"};
+    bool seen[7] = {false};
+
+    std::string key;
+    while (in >> key) {
+        if (key == "sequence") in >> config->sequence;
+        else if (key == "size") in >> config->width >> config->height >> config->depth;
+        else if (key == "chunk") in >> config->chunkSize;
+        else if (key == "a") in >> config->aMin >> config->aMax;
+        else if (key == "b") in >> config->bMin >> config->bMax;
+        else if (key == "c") in >> config->cMin >> config->cMax;
+        else if (key == "exponent") in >> config->expMin >> config->expMax;
+        else {
+            std::cerr << "Error: Unknown key '" << key << "' in " << metaPath(storeDir) << "\n";
+            return false;
+        }
+        if (!in) {
+            std::cerr << "Error: Malformed value for '" << key << "' in " << metaPath(storeDir) << "\n";
+            return false;
+        }
+        seen[std::find(keys, keys + 7, key) - keys] = true;
+    }
+
+    for (int i = 0; i < 7; ++i) {
+        if (!seen[i]) {
+            std::cerr << "Error: Missing key '" << keys[i] << "' in " << metaPath(storeDir) << "\n";
+            return false;
+        }
+    }
+    return validateVolumeConfig(*config);
+}
+
+uint16_t quantizeLyapunov(float lyapunov, float expMin, float expMax) {
+    if (!(expMax > expMin)) return 0; // Degenerate window, nothing to resolve
+    float t = (std::min(std::max(lyapunov, expMin), expMax) - expMin) / (expMax - expMin);
+    return static_cast<uint16_t>(std::lround(t * 65535.0f));
+}
+
+float dequantizeLyapunov(uint16_t q, float expMin, float expMax) {
+    return expMin + (expMax - expMin) * (q / 65535.0f);
+}
+
+// Only pays off for chunks that are mostly divergent and collapse into a few runs
+void encodeRLE(const std::vector<uint16_t>& voxels, std::vector<uint16_t>& runs) {
+    runs.clear();
+    size_t i = 0;
+    while (i < voxels.size()) {
+        uint16_t value = voxels[i];
+        size_t run = 1;
+        while (i + run < voxels.size() && voxels[i + run] == value && run < 65535) ++run;
+        runs.push_back(static_cast<uint16_t>(run));
+        runs.push_back(value);
+        i += run;
+    }
+}
+
+bool decodeRLE(const std::vector<uint16_t>& runs, std::vector<uint16_t>& voxels) {
+    if (runs.size() % 2 != 0) return false;
+    size_t out = 0;
+    for (size_t i = 0; i < runs.size(); i += 2) {
+        if (out + runs[i] > voxels.size()) return false;
+        std::fill_n(voxels.begin() + out, runs[i], runs[i + 1]);
+        out += runs[i];
+    }
+    return out == voxels.size();
+}
+
+// Neighbouring exponents along x are close, so the deltas are small and their high
+// bytes are mostly 0x00 or 0xFF; storing that plane apart lets deflate squeeze it
+bool encodeDelta(const std::vector<uint16_t>& voxels, int rowLength, std::vector<uint8_t>& bytes) {
+    size_t n = voxels.size();
+    std::vector<uint8_t> planes(n * 2);
+    for (size_t i = 0; i < n; ++i) {
+        uint16_t prev = (i % rowLength == 0) ? 0 : voxels[i - 1];
+        int16_t delta = static_cast<int16_t>(static_cast<uint16_t>(voxels[i] - prev));
+        uint16_t zigzag = static_cast<uint16_t>((static_cast<uint16_t>(delta) << 1) ^ (delta >> 15));
+        planes[i] = static_cast<uint8_t>(zigzag >> 8);
+        planes[n + i] = static_cast<uint8_t>(zigzag & 0xFF);
+    }
+
+    uLongf compressedSize = compressBound(planes.size());
+    bytes.resize(compressedSize);
+    if (compress2(bytes.data(), &compressedSize, planes.data(), planes.size(), Z_DEFAULT_COMPRESSION) != Z_OK) {
+        return false;
+    }
+    bytes.resize(compressedSize);
+    return true;
+}
+
+bool decodeDelta(const std::vector<uint8_t>& bytes, int rowLength, std::vector<uint16_t>& voxels) {
+    size_t n = voxels.size();
+    std::vector<uint8_t> planes(n * 2);
+    uLongf planesSize = planes.size();
+    if (uncompress(planes.data(), &planesSize, bytes.data(), bytes.size()) != Z_OK || planesSize != planes.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        uint16_t zigzag = static_cast<uint16_t>((planes[i] << 8) | planes[n + i]);
+        uint16_t delta = static_cast<uint16_t>((zigzag >> 1) ^ (0 - (zigzag & 1)));
+        uint16_t prev = (i % rowLength == 0) ? 0 : voxels[i - 1];
+        voxels[i] = static_cast<uint16_t>(prev + delta);
+    }
+    return true;
+}
+
+// Writes to a temporary file and renames it into place, so a chunk on disk is always complete.
+// The payload is whichever of raw, run-length or delta encoding comes out smallest.
+static bool writeChunk(const std::string& path, const std::vector<uint16_t>& voxels, int rowLength) {
+    std::vector<uint8_t> payload(voxels.size() * sizeof(uint16_t));
+    std::memcpy(payload.data(), voxels.data(), payload.size());
+    uint8_t encoding = ENCODING_RAW;
+
+    std::vector<uint16_t> runs;
+    encodeRLE(voxels, runs);
+    if (runs.size() * sizeof(uint16_t) < payload.size()) {
+        payload.resize(runs.size() * sizeof(uint16_t));
+        std::memcpy(payload.data(), runs.data(), payload.size());
+        encoding = ENCODING_RLE;
+    }
+
+    std::vector<uint8_t> deltaBytes;
+    if (encodeDelta(voxels, rowLength, deltaBytes) && deltaBytes.size() < payload.size()) {
+        payload.swap(deltaBytes);
+        encoding = ENCODING_DELTA;
+    }
+
+    ChunkHeader header;
+    std::memcpy(header.magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC));
+    header.encoding = encoding;
+    std::memset(header.reserved, 0, sizeof(header.reserved));
+    header.voxelCount = static_cast<uint32_t>(voxels.size());
+    header.payloadBytes = static_cast<uint32_t>(payload.size());
+
+    std::string tmpPath = path + ".tmp";
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (out) {
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+        out.close();
+    }
+    if (!out || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Opens a chunk and reads its header, checking it against the expected voxel count and the
+// real file size so a corrupt header can never make the caller allocate more than is on disk
+static bool openChunk(const std::string& path, size_t voxelCount, std::ifstream& in, ChunkHeader* header) {
+    in.open(path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    std::streamoff fileSize = in.tellg();
+    in.seekg(0);
+
+    in.read(reinterpret_cast<char*>(header), sizeof(*header));
+    if (!in || std::memcmp(header->magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC)) != 0) return false;
+    if (header->voxelCount != voxelCount) return false;
+    if (fileSize != static_cast<std::streamoff>(sizeof(*header) + header->payloadBytes)) return false;
+
+    // Raw and run-length payloads are never larger than the raw voxels
+    if (header->encoding != ENCODING_DELTA && header->payloadBytes > voxelCount * sizeof(uint16_t)) return false;
+    return true;
+}
+
+static bool readChunk(const std::string& path, int rowLength, std::vector<uint16_t>& voxels) {
+    std::ifstream in;
+    ChunkHeader header;
+    if (!openChunk(path, voxels.size(), in, &header)) return false;
+
+    std::vector<uint8_t> payload(header.payloadBytes);
+    in.read(reinterpret_cast<char*>(payload.data()), payload.size());
+    if (!in) return false;
+
+    if (header.encoding == ENCODING_DELTA) return decodeDelta(payload, rowLength, voxels);
+
+    std::vector<uint16_t> words(payload.size() / sizeof(uint16_t));
+    std::memcpy(words.data(), payload.data(), words.size() * sizeof(uint16_t));
+    if (header.encoding == ENCODING_RLE) return decodeRLE(words, voxels);
+    if (header.encoding != ENCODING_RAW || words.size() != voxels.size()) return false;
+    voxels.swap(words);
+    return true;
+}
+
+// A chunk counts as done when its file exists with a valid header and the full payload
+static bool chunkComplete(const std::string& path, size_t voxelCount) {
+    std::ifstream in;
+    ChunkHeader header;
+    return openChunk(path, voxelCount, in, &header);
+}
+
+bool computeVolume(const std::string& storeDir, const VolumeConfig& config) {
+    if (!validateVolumeConfig(config)) return false;
+
+    std::error_code ec;
+    fs::create_directories(storeDir, ec);
+    if (ec) {
+        std::cerr << "Error: Cannot create " << storeDir << ": " << ec.message() << "\n";
+        return false;
+    }
+
+    // A store may only be resumed with the exact same parameters
+    std::string meta = serializeConfig(config);
+    std::ifstream existing(metaPath(storeDir));
+    if (existing) {
+        std::stringstream buffer;
+        buffer << existing.rdbuf();
+        if (buffer.str() != meta) {
+            std::cerr << "Error: " << storeDir << " holds a different volume\n";
+            return false;
+        }
+    } else {
+        std::ofstream out(metaPath(storeDir));
+        out << meta;
+        if (!out) {
+            std::cerr << "Error: Cannot write " << metaPath(storeDir) << "\n";
+            return false;
+        }
+    }
+
+    const int cs = config.chunkSize;
+    const int64_t nx = chunkCount(config.width, cs);
+    const int64_t ny = chunkCount(config.height, cs);
+    const int64_t nz = chunkCount(config.depth, cs);
+    const int64_t totalChunks = nx * ny * nz;
+
+    float aScale = (config.aMax - config.aMin) / config.width;
+    float bScale = (config.bMax - config.bMin) / config.height;
+    float cScale = (config.cMax - config.cMin) / config.depth;
+
+    std::atomic<int64_t> done(0);
+    std::atomic<bool> failed(false);
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Each thread only ever holds one chunk, so memory stays bounded by threads * chunkSize^3
+    #pragma omp parallel for schedule(dynamic)
+    for (int64_t chunk = 0; chunk < totalChunks; ++chunk) {
+        if (failed) continue;
+
+        int cx = static_cast<int>(chunk % nx);
+        int cy = static_cast<int>((chunk / nx) % ny);
+        int cz = static_cast<int>(chunk / (nx * ny));
+        int w = chunkExtent(config.width, cs, cx);
+        int h = chunkExtent(config.height, cs, cy);
+        int d = chunkExtent(config.depth, cs, cz);
+
+        std::string path = chunkPath(storeDir, cx, cy, cz);
+        if (chunkComplete(path, static_cast<size_t>(w) * h * d)) {
+            // Drop a partial write left over from an interrupted run
+            std::error_code removeError;
+            fs::remove(path + ".tmp", removeError);
+        } else {
+            std::vector<uint16_t> voxels(static_cast<size_t>(w) * h * d);
+            for (int z = 0; z < d; ++z) {
+                float c = config.cMin + (cz * cs + z) * cScale;
+                for (int y = 0; y < h; ++y) {
+                    float b = config.bMin + (cy * cs + y) * bScale;
+                    for (int x = 0; x < w; ++x) {
+                        float a = config.aMin + (cx * cs + x) * aScale;
+
+                        float lyapunov = computeLyapunov3(config.sequence, a, b, c);
+                        voxels[(static_cast<size_t>(z) * h + y) * w + x] =
+                            quantizeLyapunov(lyapunov, config.expMin, config.expMax);
+                    }
+                }
+            }
+
+            if (!writeChunk(path, voxels, w)) {
+                #pragma omp critical
+                std::cerr << "Error: Cannot write " << path << "\n";
+                failed = true;
+                continue;
+            }
+        }
+
+        int64_t finished = ++done;
+        if (finished % 64 == 0 || finished == totalChunks) {
+            #pragma omp critical
+            std::cout << "Chunks " << finished << "/" << totalChunks << "\n";
+        }
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+    std::cout << "Volume computed in " << duration << " ms\n";
+
+    return !failed;
+}
+
+bool extractSlice(const std::string& storeDir, const VolumeConfig& config, int z, std::vector<float>& slice) {
+    if (z < 0 || z >= config.depth) {
+        std::cerr << "Error: Slice " << z << " is outside [0, " << config.depth << ")\n";
+        return false;
+    }
+
+    const int cs = config.chunkSize;
+    const int64_t nx = chunkCount(config.width, cs);
+    const int64_t ny = chunkCount(config.height, cs);
+    const int cz = z / cs;
+    const int zLocal = z % cs;
+    const int d = chunkExtent(config.depth, cs, cz);
+
+    slice.assign(static_cast<size_t>(config.width) * config.height, 0.0f);
+    std::atomic<bool> failed(false);
+
+    // Only the chunks intersecting the slice are read
+    #pragma omp parallel for schedule(dynamic)
+    for (int64_t chunk = 0; chunk < nx * ny; ++chunk) {
+        int cx = static_cast<int>(chunk % nx);
+        int cy = static_cast<int>(chunk / nx);
+        int w = chunkExtent(config.width, cs, cx);
+        int h = chunkExtent(config.height, cs, cy);
+
+        std::string path = chunkPath(storeDir, cx, cy, cz);
+        std::vector<uint16_t> voxels(static_cast<size_t>(w) * h * d);
+        if (!readChunk(path, w, voxels)) {
+            #pragma omp critical
+            std::cerr << "Error: Missing or corrupt chunk " << path << "\n";
+            failed = true;
+            continue;
+        }
+
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                uint16_t q = voxels[(static_cast<size_t>(zLocal) * h + y) * w + x];
+                slice[static_cast<size_t>(cy * cs + y) * config.width + cx * cs + x] =
+                    dequantizeLyapunov(q, config.expMin, config.expMax);
+            }
+        }
+    }
+
+    return !failed;
+}
+
+bool projectVolume(const std::string& storeDir, const VolumeConfig& config, ProjectionMode mode,
+                   std::vector<float>& image) {
+
+    const int cs = config.chunkSize;
+    const int64_t nx = chunkCount(config.width, cs);
+    const int64_t ny = chunkCount(config.height, cs);
+    const int64_t nz = chunkCount(config.depth, cs);
+    const bool useMax = (mode == ProjectionMode::Max);
+
+    // Reduce in the quantized domain; the mapping is monotonic so max/min are preserved
+    std::vector<uint16_t> reduced(static_cast<size_t>(config.width) * config.height,
+                                  useMax ? 0 : 65535);
+    std::atomic<bool> failed(false);
+
+    // Each (cx, cy) column owns a disjoint tile of the image and walks its chunks along c
+    #pragma omp parallel for schedule(dynamic)
+    for (int64_t column = 0; column < nx * ny; ++column) {
+        int cx = static_cast<int>(column % nx);
+        int cy = static_cast<int>(column / nx);
+        int w = chunkExtent(config.width, cs, cx);
+        int h = chunkExtent(config.height, cs, cy);
+
+        std::vector<uint16_t> voxels;
+        for (int cz = 0; cz < nz && !failed; ++cz) {
+            int d = chunkExtent(config.depth, cs, cz);
+            std::string path = chunkPath(storeDir, cx, cy, cz);
+            voxels.assign(static_cast<size_t>(w) * h * d, 0);
+            if (!readChunk(path, w, voxels)) {
+                #pragma omp critical
+                std::cerr << "Error: Missing or corrupt chunk " << path << "\n";
+                failed = true;
+                break;
+            }
+
+            for (int z = 0; z < d; ++z) {
+                for (int y = 0; y < h; ++y) {
+                    uint16_t* row = &reduced[static_cast<size_t>(cy * cs + y) * config.width + cx * cs];
+                    const uint16_t* src = &voxels[(static_cast<size_t>(z) * h + y) * w];
+                    for (int x = 0; x < w; ++x) {
+                        row[x] = useMax ? std::max(row[x], src[x]) : std::min(row[x], src[x]);
+                    }
+                }
+            }
+        }
+    }
+
+    image.resize(reduced.size());
+    for (size_t i = 0; i < reduced.size(); ++i) {
+        image[i] = dequantizeLyapunov(reduced[i], config.expMin, config.expMax);
+    }
+    return !failed;
+}
+
+bool writeLyapunovPPM(const std::string& path, const std::vector<float>& exponents, int width, int height) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Error: Cannot write " << path << "\n";
+        return false;
+    }
+
+    out << "P6\n" << width << " " << height << "\n255\n";
+    std::vector<uint8_t> row(static_cast<size_t>(width) * 3);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            // mapLyapunovToColor returns RGBA, drop the alpha byte
+            uint32_t color = mapLyapunovToColor(exponents[static_cast<size_t>(y) * width + x]);
+            row[x * 3 + 0] = (color >> 24) & 0xFF;
+            row[x * 3 + 1] = (color >> 16) & 0xFF;
+            row[x * 3 + 2] = (color >> 8) & 0xFF;
+        }
+        out.write(reinterpret_cast<const char*>(row.data()), row.size());
+    }
+    return static_cast<bool>(out);
+}
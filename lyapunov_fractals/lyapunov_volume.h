@@ -0,0 +1,67 @@
+#ifndef LYAPUNOV_VOLUME_H
+#define LYAPUNOV_VOLUME_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Description of a three-parameter (a, b, c) Lyapunov volume.
+// The grid is split into cubic chunks of chunkSize^3 voxels; every chunk is
+// stored as its own quantized, compressed file inside the store directory.
+struct VolumeConfig {
+    std::string sequence;        // Sequence over 'A', 'B' and 'C'
+    int width = 512;             // Samples along a
+    int height = 512;            // Samples along b
+    int depth = 512;             // Samples along c
+    int chunkSize = 32;          // Chunk edge length (32^3 uint16 voxels = 64 KB)
+    float aMin = 2.0f, aMax = 4.0f;
+    float bMin = 2.0f, bMax = 4.0f;
+    float cMin = 2.0f, cMax = 4.0f;
+    float expMin = -4.0f;        // Exponents are clamped to [expMin, expMax]
+    float expMax = 1.0f;         // before 16-bit quantization
+};
+
+// Chunk edge lengths outside this range are either too small to amortize
+// the per-chunk file or too large for one chunk to stay cache sized
+const int MIN_CHUNK_SIZE = 8;
+const int MAX_CHUNK_SIZE = 128;
+
+enum class ProjectionMode { Max, Min };
+
+// Checks the sequence, sizes, chunk size and parameter/exponent ranges, printing the first problem found.
+bool validateVolumeConfig(const VolumeConfig& config);
+
+// Computes every missing chunk of the volume in parallel and writes it to storeDir.
+// Chunks already present on disk are skipped, so an interrupted run resumes where it stopped.
+// Returns false if the store cannot be created or belongs to a different volume.
+bool computeVolume(const std::string& storeDir, const VolumeConfig& config);
+
+// Reads the volume description back from storeDir.
+bool loadVolumeConfig(const std::string& storeDir, VolumeConfig* config);
+
+// Streams the z-slice (fixed c index) out of the store into slice (width * height exponents).
+// config is the store's description, as returned by loadVolumeConfig.
+bool extractSlice(const std::string& storeDir, const VolumeConfig& config, int z, std::vector<float>& slice);
+
+// Reduces the volume along c into image (width * height exponents), one chunk at a time.
+bool projectVolume(const std::string& storeDir, const VolumeConfig& config, ProjectionMode mode,
+                   std::vector<float>& image);
+
+// Chunk codec, exposed for test_lyapunov_volume.cpp
+
+// Maps an exponent clamped to [expMin, expMax] onto the full uint16 range and back
+uint16_t quantizeLyapunov(float lyapunov, float expMin, float expMax);
+float dequantizeLyapunov(uint16_t q, float expMin, float expMax);
+
+// Run-length encodes voxels as (count, value) pairs, runs longer than 65535 are split
+void encodeRLE(const std::vector<uint16_t>& voxels, std::vector<uint16_t>& runs);
+bool decodeRLE(const std::vector<uint16_t>& runs, std::vector<uint16_t>& voxels);
+
+// Deltas along x (rows of rowLength voxels), zigzagged, split into high and low byte planes and deflated
+bool encodeDelta(const std::vector<uint16_t>& voxels, int rowLength, std::vector<uint8_t>& bytes);
+bool decodeDelta(const std::vector<uint8_t>& bytes, int rowLength, std::vector<uint16_t>& voxels);
+
+// Writes exponents as a binary PPM image using mapLyapunovToColor.
+bool writeLyapunovPPM(const std::string& path, const std::vector<float>& exponents, int width, int height);
+
+#endif // LYAPUNOV_VOLUME_H
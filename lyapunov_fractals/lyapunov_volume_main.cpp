@@ -0,0 +1,145 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include "lyapunov_volume.h"
+
+static void printUsage(const char* program) {
+    std::cerr << "Usage:\n";
+    std::cerr << "  " << program << " compute <store> <sequence> [options]\n";
+    std::cerr << "      --size N | --size W H D   samples along a, b, c (default 512)\n";
+    std::cerr << "      --chunk N                 chunk edge length in [" << MIN_CHUNK_SIZE << ", "
+              << MAX_CHUNK_SIZE << "] (default 32)\n";
+    std::cerr << "      --a MIN MAX, --b MIN MAX, --c MIN MAX   parameter ranges (default 2 4)\n";
+    std::cerr << "      --exp MIN MAX             exponent clamp window (default -4 1)\n";
+    std::cerr << "  " << program << " slice <store> <z> <output.ppm>\n";
+    std::cerr << "  " << program << " project <store> <max|min> <output.ppm>\n";
+    std::cerr << "Example: " << program << " compute volume_abc AABCB --size 512 --c 3 4\n";
+}
+
+// Parses the whole string as an int, rejecting trailing characters and overflow
+static bool parseInt(const char* text, int* value) {
+    char* end;
+    errno = 0;
+    long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || parsed < INT_MIN || parsed > INT_MAX) {
+        std::cerr << "Error: '" << text << "' is not an integer.\n";
+        return false;
+    }
+    *value = static_cast<int>(parsed);
+    return true;
+}
+
+static bool parseFloat(const char* text, float* value) {
+    char* end;
+    errno = 0;
+    float parsed = std::strtof(text, &end);
+    if (end == text || *end != '\0' || errno == ERANGE || !std::isfinite(parsed)) {
+        std::cerr << "Error: '" << text << "' is not a number.\n";
+        return false;
+    }
+    *value = parsed;
+    return true;
+}
+
+// Reads the options following the sequence into config
+static bool parseComputeOptions(int argc, char* argv[], int first, VolumeConfig* config) {
+    for (int i = first; i < argc; ++i) {
+        std::string option = argv[i];
+        int remaining = argc - i - 1;
+
+        if (option == "--size") {
+            // Either one cubic size or three explicit sizes
+            int values = 0;
+            while (values < remaining && std::strncmp(argv[i + 1 + values], "--", 2) != 0) ++values;
+            if (values != 1 && values != 3) {
+                std::cerr << "Error: --size takes N or W H D.\n";
+                return false;
+            }
+
+            if (!parseInt(argv[i + 1], &config->width)) return false;
+            if (values == 3) {
+                if (!parseInt(argv[i + 2], &config->height) || !parseInt(argv[i + 3], &config->depth)) return false;
+            } else {
+                config->height = config->depth = config->width;
+            }
+            i += values;
+        } else if (option == "--chunk") {
+            if (remaining < 1 || !parseInt(argv[i + 1], &config->chunkSize)) return false;
+            i += 1;
+        } else if (option == "--a" || option == "--b" || option == "--c" || option == "--exp") {
+            float* range[2];
+            if (option == "--a") { range[0] = &config->aMin; range[1] = &config->aMax; }
+            else if (option == "--b") { range[0] = &config->bMin; range[1] = &config->bMax; }
+            else if (option == "--c") { range[0] = &config->cMin; range[1] = &config->cMax; }
+            else { range[0] = &config->expMin; range[1] = &config->expMax; }
+
+            if (remaining < 2 || !parseFloat(argv[i + 1], range[0]) || !parseFloat(argv[i + 2], range[1])) {
+                if (remaining < 2) std::cerr << "Error: " << option << " takes MIN MAX.\n";
+                return false;
+            }
+            i += 2;
+        } else {
+            std::cerr << "Error: Unknown option '" << option << "'.\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string command = argv[1];
+    std::string storeDir = argv[2];
+
+    if (command == "compute") {
+        if (argc < 4) {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        VolumeConfig config;
+        config.sequence = argv[3];
+        if (!parseComputeOptions(argc, argv, 4, &config)) return 1;
+
+        return computeVolume(storeDir, config) ? 0 : 1;
+    }
+
+    if (command == "slice" || command == "project") {
+        if (argc < 5) {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        VolumeConfig config;
+        if (!loadVolumeConfig(storeDir, &config)) return 1;
+
+        std::vector<float> image;
+        bool ok;
+        if (command == "slice") {
+            int z;
+            if (!parseInt(argv[3], &z)) return 1;
+            ok = extractSlice(storeDir, config, z, image);
+        } else if (std::strcmp(argv[3], "max") == 0 || std::strcmp(argv[3], "min") == 0) {
+            ProjectionMode mode = (std::strcmp(argv[3], "max") == 0) ? ProjectionMode::Max : ProjectionMode::Min;
+            ok = projectVolume(storeDir, config, mode, image);
+        } else {
+            std::cerr << "Error: Projection must be 'max' or 'min'.\n";
+            return 1;
+        }
+
+        if (!ok || !writeLyapunovPPM(argv[4], image, config.width, config.height)) return 1;
+        return 0;
+    }
+
+    printUsage(argv[0]);
+    return 1;
+}
@@ -0,0 +1,159 @@
+#include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <cmath>
+#include <algorithm>
+#include "lyapunov_fractal.h"
+#include "lyapunov_volume.h"
+
+namespace fs = std::filesystem;
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << "\n";
+    if (!condition) ++failures;
+}
+
+static void testRLE() {
+    // One run longer than 65535, one short run, then a single voxel
+    std::vector<uint16_t> voxels(70000 + 5 + 1, 7);
+    std::fill(voxels.begin() + 70000, voxels.end(), 9);
+    voxels.back() = 1;
+
+    std::vector<uint16_t> runs;
+    encodeRLE(voxels, runs);
+    check(runs.size() == 8, "RLE splits a 70000 voxel run into two pairs");
+
+    std::vector<uint16_t> decoded(voxels.size());
+    check(decodeRLE(runs, decoded) && decoded == voxels, "RLE round trip");
+
+    std::vector<uint16_t> tooShort(voxels.size() - 1);
+    check(!decodeRLE(runs, tooShort), "RLE rejects a size mismatch");
+}
+
+static void testDelta() {
+    // Smooth rows with a few jumps across the whole uint16 range
+    std::vector<uint16_t> voxels(13 * 9 * 5);
+    for (size_t i = 0; i < voxels.size(); ++i) {
+        voxels[i] = static_cast<uint16_t>(30000 + 40 * (i % 13) + ((i % 17 == 0) ? 35000 : 0));
+    }
+
+    std::vector<uint8_t> bytes;
+    std::vector<uint16_t> decoded(voxels.size());
+    check(encodeDelta(voxels, 13, bytes) && decodeDelta(bytes, 13, decoded) && decoded == voxels,
+          "Delta round trip");
+}
+
+static void testQuantize() {
+    float expMin = -4.0f, expMax = 1.0f;
+    float step = (expMax - expMin) / 65535.0f;
+    float worst = 0.0f;
+    for (float v = expMin; v <= expMax; v += 0.000731f) {
+        float back = dequantizeLyapunov(quantizeLyapunov(v, expMin, expMax), expMin, expMax);
+        worst = std::max(worst, std::abs(back - v));
+    }
+    check(worst <= step, "Quantization error within one step");
+    check(quantizeLyapunov(-100.0f, expMin, expMax) == 0 && quantizeLyapunov(100.0f, expMin, expMax) == 65535,
+          "Quantization clamps to the exponent window");
+}
+
+static void testVolume(const std::string& storeDir) {
+    // Sizes that are not multiples of the chunk size, so border chunks are clipped
+    VolumeConfig config;
+    config.sequence = "AABCB";
+    config.width = 20;
+    config.height = 18;
+    config.depth = 13;
+    config.chunkSize = 8;
+    config.cMin = 3.0f;
+
+    fs::remove_all(storeDir);
+    check(computeVolume(storeDir, config), "Compute small volume");
+
+    int z = 11;
+    std::vector<float> slice;
+    check(extractSlice(storeDir, config, z, slice), "Extract slice");
+
+    float aScale = (config.aMax - config.aMin) / config.width;
+    float bScale = (config.bMax - config.bMin) / config.height;
+    float cScale = (config.cMax - config.cMin) / config.depth;
+    float step = (config.expMax - config.expMin) / 65535.0f;
+    float worst = 0.0f;
+    for (int y = 0; y < config.height; ++y) {
+        for (int x = 0; x < config.width; ++x) {
+            float lyapunov = computeLyapunov3(config.sequence, config.aMin + x * aScale,
+                                              config.bMin + y * bScale, config.cMin + z * cScale);
+            lyapunov = std::min(std::max(lyapunov, config.expMin), config.expMax);
+            worst = std::max(worst, std::abs(slice[y * config.width + x] - lyapunov));
+        }
+    }
+    check(worst <= step, "Slice matches computeLyapunov3");
+
+    // Projections must equal max/min over every z-slice, including the clipped border chunks
+    VolumeConfig stored;
+    check(loadVolumeConfig(storeDir, &stored), "Load volume config");
+    std::vector<float> maxSlices(slice.size(), -INFINITY), minSlices(slice.size(), INFINITY);
+    bool slicesOk = true;
+    for (int zs = 0; zs < stored.depth; ++zs) {
+        std::vector<float> current;
+        slicesOk = extractSlice(storeDir, stored, zs, current) && slicesOk;
+        for (size_t i = 0; i < current.size(); ++i) {
+            maxSlices[i] = std::max(maxSlices[i], current[i]);
+            minSlices[i] = std::min(minSlices[i], current[i]);
+        }
+    }
+    std::vector<float> maxImage, minImage;
+    check(slicesOk && projectVolume(storeDir, stored, ProjectionMode::Max, maxImage) && maxImage == maxSlices,
+          "Max projection matches slices");
+    check(slicesOk && projectVolume(storeDir, stored, ProjectionMode::Min, minImage) && minImage == minSlices,
+          "Min projection matches slices");
+
+    // Delete one chunk, truncate another and leave a stale temporary behind
+    fs::path deleted = fs::path(storeDir) / "chunk_2_2_1.bin";
+    fs::path truncated = fs::path(storeDir) / "chunk_0_1_0.bin";
+    fs::path untouched = fs::path(storeDir) / "chunk_1_0_0.bin";
+    fs::path stale = fs::path(storeDir) / "chunk_1_1_1.bin.tmp";
+    auto untouchedTime = fs::last_write_time(untouched);
+    fs::remove(deleted);
+    fs::resize_file(truncated, fs::file_size(truncated) / 2);
+    std::ofstream(stale) << "partial";
+
+    std::vector<float> broken;
+    check(!extractSlice(storeDir, config, 3, broken), "Truncated chunk is detected");
+
+    // A header claiming a huge payload must fail cleanly instead of allocating it
+    fs::path corrupt = fs::path(storeDir) / "chunk_1_1_0.bin";
+    {
+        std::fstream file(corrupt, std::ios::binary | std::ios::in | std::ios::out);
+        uint32_t hugePayload = 0xFFFFFFF0u;
+        file.seekp(12);
+        file.write(reinterpret_cast<const char*>(&hugePayload), sizeof(hugePayload));
+    }
+    check(!extractSlice(storeDir, config, 4, broken), "Corrupt payload size is detected");
+
+    check(computeVolume(storeDir, config), "Resume volume");
+    check(fs::exists(deleted), "Deleted chunk is recomputed");
+    check(!fs::exists(stale), "Stale temporary is removed");
+    check(fs::last_write_time(untouched) == untouchedTime, "Finished chunk is not rewritten");
+
+    std::vector<float> resumed;
+    check(extractSlice(storeDir, config, z, resumed) && resumed == slice, "Resumed volume matches");
+
+    VolumeConfig other = config;
+    other.sequence = "AB";
+    check(!computeVolume(storeDir, other), "Store refuses a different volume");
+
+    fs::remove_all(storeDir);
+}
+
+int main() {
+    testRLE();
+    testDelta();
+    testQuantize();
+    testVolume((fs::temp_directory_path() / "test_lyapunov_volume").string());
+
+    std::cout << "-----------------------------------\n";
+    std::cout << failures << " check(s) failed.\n";
+    return failures == 0 ? 0 : 1;
+}